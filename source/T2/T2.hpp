@@ -8,6 +8,8 @@
 // actually use in a realisting environment.
 
 #include "./net/net.hpp"
+#include "./net/impairment.hpp"
+#include "./net/rpc.hpp"
 #include "./protocols.hpp"
 #include "./utility/utility.hpp"
 
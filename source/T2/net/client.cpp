@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <functional>
 #include <iostream> // Exclusively for logging purposes.
 #include <thread>
@@ -180,12 +181,37 @@ size_t T2::net::client::receive_data_base(boost::asio::ip::tcp::socket& socket,
     T2::net::client::pending_asio_requests.object.push_back(base_request);
     pending_lock.unlock();
 
-    const bool timed_out = T2::utility::blocking_timer(receive_timeout,
+    bool timed_out = T2::utility::blocking_timer(receive_timeout,
         &base_request->work_finished);
 
+    pending_lock.lock();
+    if (timed_out && !base_request->work_finished &&
+        base_request->request_status != T2::net::client::asio_request::request_statuses::unprocessed) {
+        // The async_receive() is still outstanding and writing into data_buffer, which the caller
+        // is free to reuse (or free) once we return. Cancel it and wait for its handler so that
+        // any data that arrived in the meantime is returned rather than silently lost.
+        // The handler doesn't take pending_asio_requests.mutex so it can still finish before the
+        // cancellation runs, work_finished is re-checked on the asio_loop thread (where handlers
+        // run) to avoid aborting whatever the caller does with the socket next. We also wait for
+        // the cancellation itself as it references both the socket and the request.
+        std::atomic<bool> cancellation_processed = false;
+        boost::asio::post(T2::net::client::asio_context, [&socket, base_request, &cancellation_processed]() {
+            if (!base_request->work_finished)
+                socket.cancel();
+            cancellation_processed = true;
+        });
+        pending_lock.unlock();
+        while (!cancellation_processed || !base_request->work_finished) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        pending_lock.lock();
+    }
+    // The handler may also have finished between blocking_timer() returning and the lock being
+    // re-taken, either way whatever it received is kept.
+    if (timed_out && base_request->work_finished)
+        timed_out = base_request->request_status != T2::net::client::asio_request::request_statuses::success;
     const size_t bytes_received = base_request->request.receive_details.bytes_received;
     const T2::net::client::asio_request::request_statuses request_status = base_request->request_status;
-    pending_lock.lock();
     base_request->disposal_flag = true;
     pending_lock.unlock();
 
@@ -218,6 +244,129 @@ size_t T2::net::client::receive_data_base(boost::asio::ip::tcp::socket& socket,
     return bytes_received;
 }
 
+std::vector<T2::net::client::batch_receive_result> T2::net::client::receive_data_batch(
+    const std::vector<std::pair<T2::net::client*, boost::asio::mutable_buffer>>& batch,
+    const std::chrono::milliseconds& timeout) {
+
+    std::vector<std::pair<std::reference_wrapper<boost::asio::ip::tcp::socket>, boost::asio::mutable_buffer>> sockets;
+    sockets.reserve(batch.size());
+    for (const std::pair<T2::net::client*, boost::asio::mutable_buffer>& iterative_entry : batch)
+        sockets.emplace_back(iterative_entry.first->connection_socket, iterative_entry.second);
+    return T2::net::client::receive_data_batch_base(sockets, timeout);
+}
+
+std::vector<T2::net::client::batch_receive_result> T2::net::client::receive_data_batch_base(
+    const std::vector<std::pair<std::reference_wrapper<boost::asio::ip::tcp::socket>,
+        boost::asio::mutable_buffer>>& batch,
+    const std::chrono::milliseconds& receive_timeout) {
+
+    if (batch.empty())
+        return {}; // Nothing could ever finish, don't wait out the timeout.
+
+    T2::net::client::initialization();
+
+    std::vector<T2::net::client::asio_request*> requests;
+    requests.reserve(batch.size());
+    for (const std::pair<std::reference_wrapper<boost::asio::ip::tcp::socket>,
+        boost::asio::mutable_buffer>& iterative_entry : batch) {
+        requests.push_back(new T2::net::client::asio_request{
+            .request_type = T2::net::client::asio_request::asio_request_types::receive_data,
+            .socket = iterative_entry.first.get(),
+            .request.receive_details = {
+                .buffer = iterative_entry.second,
+                .bytes_received = 0
+            }
+        });
+    }
+
+    // Submitting (and later disposing of) the whole batch under one lock is the point of this
+    // function, calling ...::receive_data_base() per socket takes the lock twice per socket.
+    std::unique_lock pending_lock(T2::net::client::pending_asio_requests.mutex);
+    T2::net::client::pending_asio_requests.object.insert(
+        T2::net::client::pending_asio_requests.object.end(), requests.begin(), requests.end());
+    pending_lock.unlock();
+
+    // T2::utility::blocking_timer only watches one flag, so this is its 'any of' counterpart.
+    // TOTWEAK: The intermission trades CPU time for latency, like blocking_timer's does.
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + receive_timeout;
+    while (std::chrono::steady_clock::now() < deadline &&
+        std::none_of(requests.begin(), requests.end(), [](const T2::net::client::asio_request* const request) {
+            return request->work_finished;
+        })) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Anything still outstanding is cancelled (with one post() for the whole batch) and waited
+    // upon so that the caller's buffers are no longer referenced once we return. Data that
+    // slips in before the cancellation is still reported. As in ...::receive_data_base(), handlers
+    // finish without the lock so completion is re-checked on the asio_loop thread before each
+    // cancel(), otherwise we could abort the caller's next receive on a socket.
+    std::vector<bool> cancelled(requests.size(), false);
+    std::vector<bool> abandoned(requests.size(), false); // asio_loop may delete these at any time.
+    std::vector<T2::net::client::asio_request*> cancelled_requests;
+    std::atomic<bool> cancellation_processed = true;
+    pending_lock.lock();
+    for (size_t index = 0; index < requests.size(); index++) {
+        if (requests[index]->work_finished)
+            continue;
+        cancelled[index] = true;
+        if (requests[index]->request_status == T2::net::client::asio_request::request_statuses::unprocessed) {
+            requests[index]->disposal_flag = true; // asio_loop never started it, so won't now.
+            abandoned[index] = true;
+        }
+        else
+            cancelled_requests.push_back(requests[index]);
+    }
+    if (!cancelled_requests.empty()) {
+        cancellation_processed = false;
+        boost::asio::post(T2::net::client::asio_context, [cancelled_requests, &cancellation_processed]() {
+            for (T2::net::client::asio_request* const iterative_request : cancelled_requests) {
+                if (!iterative_request->work_finished)
+                    iterative_request->socket.cancel();
+            }
+            cancellation_processed = true;
+        });
+    }
+    pending_lock.unlock();
+
+    while (!cancellation_processed) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    for (size_t index = 0; index < requests.size(); index++) {
+        while (!abandoned[index] && !requests[index]->work_finished) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    std::vector<T2::net::client::batch_receive_result> results;
+    pending_lock.lock();
+    for (size_t index = 0; index < requests.size(); index++) {
+        if (abandoned[index])
+            continue;
+        T2::net::client::asio_request* const iterative_request = requests[index];
+
+        if (iterative_request->request_status == T2::net::client::asio_request::request_statuses::success) {
+            results.push_back({
+                .index = index,
+                .bytes_received = iterative_request->request.receive_details.bytes_received,
+                .failed = false
+            });
+        }
+        else if (!cancelled[index]) {
+            // Failures of cancelled requests are (almost always) just the cancellation itself.
+            results.push_back({ .index = index, .bytes_received = 0, .failed = true });
+        }
+        iterative_request->disposal_flag = true;
+    }
+    pending_lock.unlock();
+
+#if defined(_DEBUG)
+    std::clog << "T2::net::client::receive_data_batch_base() @ " + std::to_string(__LINE__) + ": " +
+        std::to_string(results.size()) + "/" + std::to_string(batch.size()) + " sockets were ready.\r\n";
+#endif
+    return results;
+}
+
 T2::net::client::~client() {
     if (this->connection_state == connected) {
         this->disconnect(); // No need to wrap this in a try/catch, we've just checked connection_state.
@@ -271,7 +420,7 @@ void T2::net::client::asio_loop() {
                         const T2::net::client::asio_request::request_specific::connection_request& details =
                             iterative_request->request.connection_details;
                         iterative_request->socket.async_connect(details.endpoint,
-                        [&iterative_request, &details](const boost::system::error_code& error) {
+                        [iterative_request, &details](const boost::system::error_code& error) {
                             const std::string dest_string = "'" + boost::lexical_cast<std::string>(details.endpoint) + "'";
                             if (error) {
                                 iterative_request->request_status =
@@ -300,7 +449,7 @@ void T2::net::client::asio_loop() {
                     case T2::net::client::asio_request::asio_request_types::receive_data: {
                         iterative_request->socket.async_receive(
                             iterative_request->request.receive_details.buffer,
-                            [&iterative_request](const boost::system::error_code& error,
+                            [iterative_request](const boost::system::error_code& error,
                                 size_t bytes_transferred) {
                             
                                 if (error) {
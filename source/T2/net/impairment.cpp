@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream> // Exclusively for logging purposes.
+#include <memory>
+#include <mutex>
+#include <random>
+
+#include "./impairment.hpp"
+
+T2::net::impairment_proxy::impairment_proxy(const uint16_t port,
+    const boost::asio::ip::tcp::endpoint& upstream, const T2::net::impairment_profile& profile) :
+    impairment_proxy(port, upstream, profile, profile) { }
+
+T2::net::impairment_proxy::impairment_proxy(const uint16_t port,
+    const boost::asio::ip::tcp::endpoint& upstream, const T2::net::impairment_profile& to_upstream,
+    const T2::net::impairment_profile& to_downstream) :
+    upstream(upstream), to_upstream(to_upstream), to_downstream(to_downstream),
+    acceptor(this->proxy_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port)),
+    port(this->acceptor.local_endpoint().port()) {
+
+    for (const T2::net::impairment_profile* const iterative_profile : { &to_upstream, &to_downstream }) {
+        if (iterative_profile->max_segment_size == 0 || iterative_profile->window == 0) {
+            std::__throw_runtime_error("T2::net::impairment_profile requires a non-zero max_segment_size "
+                "and window.");
+        }
+        if (iterative_profile->stall_probability < 0.0 || iterative_profile->stall_probability > 1.0)
+            std::__throw_runtime_error("T2::net::impairment_profile::stall_probability must be within [0, 1].");
+    }
+
+    this->accept_next();
+    this->accept_thread = std::thread([this]() { this->proxy_context.run(); });
+}
+
+void T2::net::impairment_proxy::accept_next() {
+    this->acceptor.async_accept([this](const boost::system::error_code& error,
+        boost::asio::ip::tcp::socket downstream) {
+
+        if (error == boost::asio::error::operation_aborted)
+            return; // The destructor closed the acceptor.
+        if (!error) {
+            // Incremented here (rather than in relay) so the destructor can't miss a relay that
+            // has been accepted but hasn't started yet.
+            ++this->active_relays;
+            // Handed over as a pointer, a moved-from socket in the thread's arguments would only
+            // be destroyed after relay() returns (and so possibly after proxy_context).
+            std::thread(&T2::net::impairment_proxy::relay, this,
+                new boost::asio::ip::tcp::socket(std::move(downstream)), this->connection_count++).detach();
+        }
+        else {
+#if defined(_DEBUG)
+            std::cerr << "T2::net::impairment_proxy::accept_next() @ " + std::to_string(__LINE__) + ": "
+                "accept() failed - " + error.message() + ".\r\n";
+#endif
+            // Errors like EMFILE tend to persist, retrying straight away would spin.
+            std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        }
+        this->accept_next();
+    });
+}
+
+void T2::net::impairment_proxy::relay(boost::asio::ip::tcp::socket* const downstream,
+    const uint64_t connection_index) {
+    {
+        // Both sockets are tied to proxy_context, they must be destroyed before active_relays
+        // drops as that's the destructor's cue to destroy proxy_context.
+        const std::unique_ptr<boost::asio::ip::tcp::socket> downstream_owner(downstream);
+        this->relay_connection(*downstream, connection_index);
+    }
+    --this->active_relays;
+}
+
+void T2::net::impairment_proxy::relay_connection(boost::asio::ip::tcp::socket& downstream,
+    const uint64_t connection_index) {
+    boost::asio::ip::tcp::socket upstream_socket(this->proxy_context);
+    boost::system::error_code error_code;
+    upstream_socket.connect(this->upstream, error_code);
+    if (error_code) {
+#if defined(_DEBUG)
+        std::cerr << "T2::net::impairment_proxy::relay() @ " + std::to_string(__LINE__) + ": "
+            "Failed to reach upstream - " + error_code.message() + ".\r\n";
+#endif
+        return; // Closing downstream (by destructing it) tells the client.
+    }
+    // Nagle's algorithm would merge our segments back together again.
+    downstream.set_option(boost::asio::ip::tcp::no_delay(true), error_code);
+    upstream_socket.set_option(boost::asio::ip::tcp::no_delay(true), error_code);
+
+    std::unique_lock sockets_lock(this->relay_sockets.mutex);
+    this->relay_sockets.object.push_back(&downstream);
+    this->relay_sockets.object.push_back(&upstream_socket);
+    if (this->stopping) {
+        downstream.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error_code);
+        upstream_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error_code);
+    }
+    sockets_lock.unlock();
+
+    std::thread upstream_pump(T2::net::impairment_proxy::pump, std::ref(downstream), std::ref(upstream_socket),
+        std::cref(this->to_upstream), connection_index, T2::net::impairment_proxy::to_upstream_direction);
+    T2::net::impairment_proxy::pump(upstream_socket, downstream, this->to_downstream, connection_index,
+        T2::net::impairment_proxy::to_downstream_direction);
+    upstream_pump.join();
+
+    sockets_lock.lock();
+    std::erase_if(this->relay_sockets.object, [&downstream, &upstream_socket](const boost::asio::ip::tcp::socket* const
+        iterative_socket) { return iterative_socket == &downstream || iterative_socket == &upstream_socket; });
+    sockets_lock.unlock();
+}
+
+void T2::net::impairment_proxy::pump(boost::asio::ip::tcp::socket& source, boost::asio::ip::tcp::socket& destination,
+    const T2::net::impairment_profile& profile, const uint64_t connection_index, const directions direction) {
+
+    struct piece {
+        std::vector<uint8_t> data;
+        std::chrono::steady_clock::time_point release_time;
+        bool stall; // Set on the first piece of a segment that was chosen to stall.
+    };
+    // Models the link's capacity (plus the receiver's window), the reader stops once it's full.
+    const size_t capacity = profile.window + static_cast<size_t>(profile.bandwidth *
+        std::chrono::duration<double>(profile.latency + profile.jitter).count());
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_changed;
+    std::deque<piece> queue;
+    size_t queued_bytes = 0;
+    bool source_closed = false;
+    bool failed = false;
+
+    // Latency is applied by the reader (as data arrives) and everything else by the writer (as it
+    // leaves), this way a slow link doesn't stop us from timestamping data that's still arriving.
+    std::thread writer([&source, &destination, &profile, &queue_mutex, &queue_changed, &queue,
+        &queued_bytes, &source_closed, &failed]() {
+
+        std::chrono::steady_clock::time_point next_send_time = std::chrono::steady_clock::now();
+        boost::system::error_code error_code;
+        while (true) {
+            std::unique_lock queue_lock(queue_mutex);
+            queue_changed.wait(queue_lock, [&queue, &source_closed, &failed]() {
+                return !queue.empty() || source_closed || failed;
+            });
+            if (failed || queue.empty())
+                break; // Either something broke or the source closed and everything was forwarded.
+            const piece current_piece = std::move(queue.front());
+            queue.pop_front();
+            queue_lock.unlock();
+
+            std::this_thread::sleep_until(current_piece.release_time);
+            if (current_piece.stall)
+                std::this_thread::sleep_for(profile.stall_duration);
+            if (profile.bandwidth != 0) {
+                next_send_time = std::max(next_send_time, std::chrono::steady_clock::now());
+                std::this_thread::sleep_until(next_send_time);
+                next_send_time += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(static_cast<double>(current_piece.data.size()) / profile.bandwidth));
+            }
+
+            // boost::asio::write() blocks until everything is written (or the connection fails), a
+            // slow reader therefore stalls us here and, once the queue fills, the reader too.
+            boost::asio::write(destination, boost::asio::buffer(current_piece.data), error_code);
+            queue_lock.lock();
+            queued_bytes -= current_piece.data.size();
+            if (error_code) {
+#if defined(_DEBUG)
+                std::cerr << "T2::net::impairment_proxy::pump() @ " + std::to_string(__LINE__) + ": "
+                    "Failed to forward data - " + error_code.message() + ".\r\n";
+#endif
+                // Skipping this piece and carrying on would leave a hole in the middle of the stream.
+                failed = true;
+            }
+            queue_lock.unlock();
+            queue_changed.notify_all();
+        }
+
+        if (failed) {
+            // Tearing down both sockets also wakes our reader and ends the opposite pump.
+            source.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error_code);
+            destination.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error_code);
+        }
+        else {
+            // Pass the closure on, the other side closing in turn ends the opposite pump.
+            destination.shutdown(boost::asio::ip::tcp::socket::shutdown_send, error_code);
+        }
+    });
+
+    // Decisions are drawn at fixed stream offsets (the start of each segment) in a fixed order so
+    // that they don't depend on how TCP happened to split up the data we read.
+    std::seed_seq seed_sequence{
+        static_cast<uint32_t>(profile.seed), static_cast<uint32_t>(profile.seed >> 32),
+        static_cast<uint32_t>(connection_index), static_cast<uint32_t>(connection_index >> 32),
+        static_cast<uint32_t>(direction)
+    };
+    std::mt19937_64 random(seed_sequence);
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter_distribution(0, profile.jitter.count());
+    std::bernoulli_distribution stall_distribution(profile.stall_probability);
+
+    uint64_t stream_offset = 0;
+    std::chrono::milliseconds segment_delay = profile.latency;
+    bool segment_stalls = false;
+    std::chrono::steady_clock::time_point last_release_time = std::chrono::steady_clock::now();
+    std::vector<uint8_t> receive_buffer(std::min<size_t>(capacity, 64 * 1024));
+    std::vector<piece> pieces;
+    boost::system::error_code error_code;
+
+    while (true) {
+        std::unique_lock queue_lock(queue_mutex);
+        queue_changed.wait(queue_lock, [&queued_bytes, &capacity, &failed]() {
+            return queued_bytes < capacity || failed;
+        });
+        if (failed)
+            break;
+        const size_t room = std::min(capacity - queued_bytes, receive_buffer.size());
+        queue_lock.unlock();
+
+        const size_t bytes_received = source.read_some(boost::asio::buffer(receive_buffer.data(), room), error_code);
+        if (error_code)
+            break; // Closed by the peer, by the opposite pump, or by the destructor.
+        const std::chrono::steady_clock::time_point arrival_time = std::chrono::steady_clock::now();
+
+        size_t consumed = 0;
+        while (consumed < bytes_received) {
+            const size_t segment_offset = stream_offset % profile.max_segment_size;
+            if (segment_offset == 0) {
+                segment_delay = profile.latency + std::chrono::milliseconds(jitter_distribution(random));
+                segment_stalls = stall_distribution(random);
+            }
+            const size_t piece_size = std::min(bytes_received - consumed, profile.max_segment_size - segment_offset);
+            // TCP doesn't reorder data so neither should we, jitter can only push segments back.
+            last_release_time = std::max(last_release_time, arrival_time + segment_delay);
+            pieces.push_back(piece{
+                .data = std::vector<uint8_t>(receive_buffer.begin() + consumed,
+                    receive_buffer.begin() + consumed + piece_size),
+                .release_time = last_release_time,
+                .stall = segment_offset == 0 && segment_stalls
+            });
+            consumed += piece_size;
+            stream_offset += piece_size;
+        }
+
+        queue_lock.lock();
+        std::move(pieces.begin(), pieces.end(), std::back_inserter(queue));
+        queued_bytes += bytes_received;
+        queue_lock.unlock();
+        queue_changed.notify_all();
+        pieces.clear();
+    }
+
+    std::unique_lock queue_lock(queue_mutex);
+    if (error_code == boost::asio::error::eof)
+        source_closed = true;
+    else
+        failed = true; // Anything but a clean close means the stream can't be trusted to be whole.
+    queue_lock.unlock();
+    queue_changed.notify_all();
+    writer.join();
+}
+
+T2::net::impairment_proxy::~impairment_proxy() {
+    boost::asio::post(this->proxy_context, [this]() { this->acceptor.close(); });
+    this->accept_thread.join();
+
+    std::unique_lock sockets_lock(this->relay_sockets.mutex);
+    this->stopping = true;
+    boost::system::error_code error_code; // Ignored, the relay may already be tearing them down.
+    for (boost::asio::ip::tcp::socket* const iterative_socket : this->relay_sockets.object)
+        iterative_socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, error_code);
+    sockets_lock.unlock();
+
+    while (this->active_relays != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef T2_NET_IMPAIRMENT
+#define T2_NET_IMPAIRMENT
+
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include <boost/asio.hpp>
+
+#include "../utility/utility.hpp"
+
+namespace T2 {
+    namespace net {
+        // Describes how one direction of a proxied connection should misbehave, the defaults
+        // describe a perfect link (besides the latency of the proxy itself).
+        struct impairment_profile {
+            std::chrono::milliseconds latency = std::chrono::milliseconds(0);
+            // Each segment is delayed by an extra [0, jitter], segments are never reordered though.
+            std::chrono::milliseconds jitter = std::chrono::milliseconds(0);
+            size_t bandwidth = 0; // Bytes per second, zero is unlimited.
+            // The stream is cut into segments at fixed multiples of this (non-zero) size, each one
+            // is written separately and gets its own jitter/stall decision. Data that arrives in
+            // smaller pieces is forwarded as-is rather than waiting for the segment to fill up.
+            size_t max_segment_size = 1460;
+            double stall_probability = 0.0; // Chance that any given segment is held back by stall_duration.
+            std::chrono::milliseconds stall_duration = std::chrono::milliseconds(0);
+            // The proxy holds at most bandwidth * (latency + jitter) + window bytes for this
+            // direction before it stops reading, so the sender feels a slow link (or reader) the
+            // way it would over TCP. With no bandwidth cap, throughput is at most window / latency.
+            size_t window = 256 * 1024;
+            // Each direction of each connection seeds its own generator from 'seed', the connection's
+            // (zero-based) index and the direction, so a run that opens connections in the same order
+            // makes the same decisions at the same stream offsets.
+            uint64_t seed = 0;
+        };
+
+        // A loopback proxy that forwards connections on 'port' to 'upstream' whilst applying
+        // an impairment_profile to each direction, intended for reproducing poor network
+        // conditions in tests and benchmarks rather than production use.
+        class impairment_proxy {
+        private:
+            enum directions {
+                to_upstream_direction,
+                to_downstream_direction
+            };
+
+            const boost::asio::ip::tcp::endpoint upstream;
+            const impairment_profile to_upstream;
+            const impairment_profile to_downstream;
+            std::atomic<uint64_t> connection_count = 0;
+
+            // Relays use blocking I/O on their own threads, this context only drives accepting.
+            boost::asio::io_context proxy_context;
+            boost::asio::ip::tcp::acceptor acceptor;
+            std::thread accept_thread;
+
+            bool stopping = false; // Guarded by relay_sockets.mutex.
+            // Tracked so that the destructor can shut them down and wake any blocked relays.
+            T2::utility::mutex_wrapped<std::vector<boost::asio::ip::tcp::socket*>> relay_sockets;
+            std::atomic<size_t> active_relays = 0;
+
+            void accept_next();
+            // Takes ownership of 'downstream', decrementing active_relays once nothing tied to
+            // proxy_context remains.
+            void relay(boost::asio::ip::tcp::socket* const downstream, const uint64_t connection_index);
+            void relay_connection(boost::asio::ip::tcp::socket& downstream, const uint64_t connection_index);
+            // Forwards everything received from 'source' to 'destination'. Once 'source' is closed
+            // the sending half of 'destination' is shut down, if either side fails both are.
+            static void pump(boost::asio::ip::tcp::socket& source, boost::asio::ip::tcp::socket& destination,
+                const impairment_profile& profile, const uint64_t connection_index, const directions direction);
+        public:
+            const uint16_t port; // The port that was actually bound, useful when zero was requested.
+
+            // Listens on the loopback interface, throws if a profile is invalid or the port is in use.
+            impairment_proxy(const uint16_t port, const boost::asio::ip::tcp::endpoint& upstream,
+                const impairment_profile& profile);
+            impairment_proxy(const uint16_t port, const boost::asio::ip::tcp::endpoint& upstream,
+                const impairment_profile& to_upstream, const impairment_profile& to_downstream);
+            // Stops accepting connections, shuts down existing ones, and waits for their relays.
+            ~impairment_proxy();
+        };
+    };
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include <chrono>
 #include <atomic>
 #include <vector>
+#include <utility>
+#include <functional>
 
 #include <boost/asio.hpp>
 
@@ -12,6 +14,8 @@
 
 namespace T2 {
     namespace net {
+        class rpc_frame; // See rpc.hpp
+
         // A TCP/IP client that is capable of connecting to a remote
         // endpoint and then transmitting data bidirectionally.
         class client {
@@ -19,6 +23,9 @@ namespace T2 {
             // of io_context (and wipe the array) if pending_asio_requests
             // gets too full as this could be the symptom of a memory leak.
             // Maybe even dump some debug info (#if 'defined(_DEBUG'), too.
+
+            // Reads and writes frames on connection_socket directly.
+            friend class T2::net::rpc_frame;
         private:
             // Shared globally
             struct asio_request {
@@ -100,6 +107,20 @@ namespace T2 {
                 const boost::asio::mutable_buffer& data_buffer,
                 const std::chrono::milliseconds& receive_timeout = std::chrono::milliseconds(2500));
 
+            // For servicing many connections from one thread, a socket should only appear once per batch.
+            struct batch_receive_result {
+                size_t index; // Position of the socket within the batch that was passed in.
+                size_t bytes_received;
+                bool failed; // The socket suffered an error (usually a disconnect) and received nothing.
+            };
+            [[nodiscard]] static std::vector<batch_receive_result> receive_data_batch(
+                const std::vector<std::pair<T2::net::client*, boost::asio::mutable_buffer>>& batch,
+                const std::chrono::milliseconds& timeout = std::chrono::milliseconds(2500));
+            [[nodiscard]] static std::vector<batch_receive_result> receive_data_batch_base(
+                const std::vector<std::pair<std::reference_wrapper<boost::asio::ip::tcp::socket>,
+                    boost::asio::mutable_buffer>>& batch,
+                const std::chrono::milliseconds& receive_timeout = std::chrono::milliseconds(2500));
+
             // This needs to be public so that external functions can instantiate their
             // sockets with this context and then use the ..._base functions as an I/O wrapper.
             static inline boost::asio::io_context asio_context;
@@ -129,7 +150,8 @@ namespace T2 {
 
             static void call_handlers(
                 const std::vector<std::function<void(T2::net::client* const)>>& handlers,
-                T2::net::client* const accepted_client
+                T2::net::client* const accepted_client,
+                const bool catch_listeners = true
             );
         };
     };
@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <iostream> // Exclusively for logging purposes.
+#include <thread>
+#include <mutex>
+
+#include "./rpc.hpp"
+
+void T2::net::rpc_frame::send(T2::net::client& connection, const uint32_t correlation_id,
+    const rpc_frame_header::frame_kinds kind, const boost::asio::const_buffer& payload) {
+
+    if (payload.size() > T2::net::rpc_frame::max_payload_size)
+        std::__throw_runtime_error("RPC payload exceeds T2::net::rpc_frame::max_payload_size.");
+
+    const T2::net::rpc_frame_header header{
+        .correlation_id = correlation_id,
+        .payload_size = static_cast<uint32_t>(payload.size()),
+        .kind = kind
+    };
+    // ...::send_data() insists on one send() call, which large payloads won't fit into once the
+    // socket's send buffer fills up, boost::asio::write() keeps going until everything is sent.
+    // The header and payload are gathered into one write so small frames cost one syscall.
+    const std::array<boost::asio::const_buffer, 2> frame = {
+        boost::asio::buffer(&header, sizeof(header)), payload
+    };
+    boost::system::error_code error_code;
+    boost::asio::write(connection.connection_socket, frame, error_code);
+    if (error_code) {
+#if defined(_DEBUG)
+        std::cerr << "T2::net::rpc_frame::send() @ " + std::to_string(__LINE__) + ": "
+            "Failed to send frame - " + error_code.message() + ".\r\n";
+#endif
+        std::__throw_runtime_error("Failed to send an RPC frame.");
+    }
+}
+
+void T2::net::rpc_frame::receive(T2::net::client& connection, rpc_frame_header& header,
+    std::vector<uint8_t>& payload) {
+
+    boost::system::error_code error_code;
+    boost::asio::read(connection.connection_socket, boost::asio::buffer(&header, sizeof(header)), error_code);
+    if (!error_code) {
+        if (header.payload_size > T2::net::rpc_frame::max_payload_size ||
+            header.kind > T2::net::rpc_frame_header::frame_kinds::error_response) {
+            std::__throw_runtime_error("Received a malformed RPC frame header.");
+        }
+        // Reading exactly the rest of the frame means we never need to hold on to the start of
+        // the next one, so there's no reassembly buffer to manage.
+        payload.resize(header.payload_size);
+        boost::asio::read(connection.connection_socket, boost::asio::buffer(payload), error_code);
+    }
+    if (error_code) {
+#if defined(_DEBUG)
+        std::clog << "T2::net::rpc_frame::receive() @ " + std::to_string(__LINE__) + ": "
+            "Failed to receive frame - " + error_code.message() + ".\r\n";
+#endif
+        std::__throw_runtime_error("Failed to receive an RPC frame (the peer has likely disconnected).");
+    }
+}
+
+void T2::net::rpc_frame::interrupt(T2::net::client& connection) {
+    boost::system::error_code error_code; // Ignored, the socket may have already been closed.
+    connection.connection_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_receive, error_code);
+}
+
+T2::net::rpc_client::rpc_client(T2::net::client& connection) : connection(connection) {
+    this->receive_thread = std::thread(&T2::net::rpc_client::receive_loop, this);
+    this->timeout_thread = std::thread(&T2::net::rpc_client::timeout_loop, this);
+}
+
+void T2::net::rpc_client::fail_pending_calls(const std::string& reason) {
+    for (std::pair<const uint32_t, pending_call>& iterative_call : this->pending_calls.object) {
+        iterative_call.second.response.set_exception(std::make_exception_ptr(std::runtime_error(reason)));
+    }
+    this->pending_calls.object.clear();
+}
+
+std::future<std::vector<uint8_t>> T2::net::rpc_client::call_async(const boost::asio::const_buffer& request,
+    const std::chrono::milliseconds& timeout) {
+
+    const uint32_t correlation_id = this->next_correlation_id++;
+    std::unique_lock pending_lock(this->pending_calls.mutex);
+    // Checked under the lock so that we can't slip a call in after receive_loop has failed
+    // everything that was pending (it would never be answered).
+    if (!this->actively_receiving) {
+        std::__throw_runtime_error("T2::net::rpc_client::call_async() was called after the "
+            "connection was lost.");
+    }
+    T2::net::rpc_client::pending_call& call = this->pending_calls.object[correlation_id];
+    call.deadline = std::chrono::steady_clock::now() + timeout;
+    std::future<std::vector<uint8_t>> response = call.response.get_future();
+    pending_lock.unlock();
+    this->pending_calls_changed.notify_one(); // This may now be the earliest deadline.
+
+    try {
+        std::unique_lock send_lock(this->send_mutex);
+        T2::net::rpc_frame::send(this->connection, correlation_id,
+            T2::net::rpc_frame_header::frame_kinds::request, request);
+    } catch (std::runtime_error&) {
+        pending_lock.lock();
+        this->pending_calls.object.erase(correlation_id);
+        pending_lock.unlock();
+        throw;
+    }
+    return response;
+}
+
+std::vector<uint8_t> T2::net::rpc_client::call(const boost::asio::const_buffer& request,
+    const std::chrono::milliseconds& timeout) {
+    return this->call_async(request, timeout).get();
+}
+
+void T2::net::rpc_client::receive_loop() {
+    std::string failure_reason = "T2::net::rpc_client was destroyed with requests in-flight.";
+    T2::net::rpc_frame_header header;
+    std::vector<uint8_t> payload;
+
+    while (this->actively_receiving) {
+        try {
+            T2::net::rpc_frame::receive(this->connection, header, payload);
+        } catch (std::runtime_error& exception_object) {
+#if defined(_DEBUG)
+            std::cerr << "T2::net::rpc_client::receive_loop() @ " + std::to_string(__LINE__) + ": "
+                "Stopped receiving - " + std::string(exception_object.what()) + ".\r\n";
+#endif
+            if (this->actively_receiving)
+                failure_reason = "RPC connection was lost: " + std::string(exception_object.what());
+            break;
+        }
+
+        std::unique_lock pending_lock(this->pending_calls.mutex);
+        const std::map<uint32_t, pending_call>::iterator call =
+            this->pending_calls.object.find(header.correlation_id);
+        if (call == this->pending_calls.object.end()) {
+            // Most likely a response to a request that has already timed out.
+#if defined(_DEBUG)
+            std::clog << "T2::net::rpc_client::receive_loop() @ " + std::to_string(__LINE__) + ": "
+                "Discarding frame for unknown correlation ID " +
+                std::to_string(header.correlation_id) + ".\r\n";
+#endif
+            continue;
+        }
+        if (header.kind == T2::net::rpc_frame_header::frame_kinds::response) {
+            call->second.response.set_value(std::move(payload));
+        }
+        else {
+            // A 'request' frame has no business arriving here, treat it as an error too.
+            call->second.response.set_exception(std::make_exception_ptr(std::runtime_error(
+                "RPC peer returned an error: " + std::string(payload.begin(), payload.end()))));
+        }
+        this->pending_calls.object.erase(call);
+        pending_lock.unlock();
+        payload = std::vector<uint8_t>(); // Moved-from above, start afresh.
+    }
+
+    std::unique_lock pending_lock(this->pending_calls.mutex);
+    this->actively_receiving = false;
+    this->fail_pending_calls(failure_reason);
+    pending_lock.unlock();
+    this->pending_calls_changed.notify_one(); // Lets timeout_loop return.
+}
+
+void T2::net::rpc_client::timeout_loop() {
+    std::unique_lock pending_lock(this->pending_calls.mutex);
+    while (this->actively_receiving) {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point next_deadline = std::chrono::steady_clock::time_point::max();
+        for (std::map<uint32_t, pending_call>::iterator iterative_call = this->pending_calls.object.begin();
+            iterative_call != this->pending_calls.object.end();) {
+            if (iterative_call->second.deadline > now) {
+                next_deadline = std::min(next_deadline, iterative_call->second.deadline);
+                ++iterative_call;
+                continue;
+            }
+            iterative_call->second.response.set_exception(std::make_exception_ptr(
+                std::runtime_error("RPC request timed out.")));
+            iterative_call = this->pending_calls.object.erase(iterative_call);
+        }
+
+        // Woken early by call_async() (for a potentially earlier deadline) or receive_loop().
+        if (next_deadline == std::chrono::steady_clock::time_point::max())
+            this->pending_calls_changed.wait(pending_lock);
+        else
+            this->pending_calls_changed.wait_until(pending_lock, next_deadline);
+    }
+}
+
+T2::net::rpc_client::~rpc_client() {
+    this->actively_receiving = false;
+    T2::net::rpc_frame::interrupt(this->connection);
+    this->receive_thread.join();
+    this->timeout_thread.join();
+}
+
+std::function<void(T2::net::client* const)> T2::net::rpc_server::dispatcher(
+    const T2::net::rpc_server::request_handler& handler, const size_t worker_count) {
+
+    return [handler, worker_count](T2::net::client* const connection) {
+        struct job {
+            uint32_t correlation_id;
+            std::vector<uint8_t> request;
+        };
+        std::mutex send_mutex;
+        T2::utility::mutex_wrapped<std::deque<job>> jobs;
+        std::condition_variable jobs_changed; // Uses jobs.mutex.
+        bool finished_reading = false;
+
+        std::vector<std::thread> workers;
+        for (size_t index = 0; index < std::max<size_t>(worker_count, 1); index++) {
+            workers.emplace_back([&handler, &send_mutex, &jobs, &jobs_changed, &finished_reading, connection]() {
+                while (true) {
+                    std::unique_lock jobs_lock(jobs.mutex);
+                    jobs_changed.wait(jobs_lock, [&jobs, &finished_reading]() {
+                        return !jobs.object.empty() || finished_reading;
+                    });
+                    if (jobs.object.empty())
+                        return; // The peer has disconnected and everything has been answered.
+                    const job current_job = std::move(jobs.object.front());
+                    jobs.object.pop_front();
+                    jobs_lock.unlock();
+                    jobs_changed.notify_all(); // The reader may be waiting for space.
+
+                    T2::net::rpc_frame_header::frame_kinds kind = T2::net::rpc_frame_header::frame_kinds::response;
+                    std::vector<uint8_t> reply;
+                    try {
+                        reply = handler(boost::asio::buffer(current_job.request));
+                    } catch (std::exception& exception_object) {
+                        const std::string error_string = exception_object.what();
+                        kind = T2::net::rpc_frame_header::frame_kinds::error_response;
+                        reply.assign(error_string.begin(), error_string.end());
+                    }
+                    try {
+                        std::unique_lock send_lock(send_mutex);
+                        T2::net::rpc_frame::send(*connection, current_job.correlation_id, kind,
+                            boost::asio::buffer(reply));
+                    } catch (std::runtime_error&) {
+                        // The reader will notice the disconnect too, keep draining until it does.
+                    }
+                }
+            });
+        }
+
+        T2::net::rpc_frame_header header;
+        std::vector<uint8_t> payload;
+        while (true) {
+            try {
+                T2::net::rpc_frame::receive(*connection, header, payload);
+            } catch (std::runtime_error& exception_object) {
+                // The peer disconnecting is the usual way out of this loop.
+#if defined(_DEBUG)
+                std::clog << "T2::net::rpc_server::dispatcher() @ " + std::to_string(__LINE__) + ": "
+                    "Stopped dispatching - " + std::string(exception_object.what()) + ".\r\n";
+#endif
+                break;
+            }
+            if (header.kind != T2::net::rpc_frame_header::frame_kinds::request) {
+#if defined(_DEBUG)
+                std::clog << "T2::net::rpc_server::dispatcher() @ " + std::to_string(__LINE__) + ": "
+                    "Ignoring non-request frame.\r\n";
+#endif
+                continue;
+            }
+
+            // Once every worker is busy and as many requests again are queued, stop reading so
+            // that TCP pushes back on the peer rather than us queueing without limit.
+            std::unique_lock jobs_lock(jobs.mutex);
+            jobs_changed.wait(jobs_lock, [&jobs, &workers]() { return jobs.object.size() < workers.size(); });
+            jobs.object.push_back(job{
+                .correlation_id = header.correlation_id,
+                .request = std::move(payload)
+            });
+            jobs_lock.unlock();
+            jobs_changed.notify_all();
+            payload = std::vector<uint8_t>(); // Moved-from above, start afresh.
+        }
+
+        std::unique_lock jobs_lock(jobs.mutex);
+        finished_reading = true;
+        jobs_lock.unlock();
+        jobs_changed.notify_all();
+        // T2::net::server::call_handlers deletes the client once we return, so every worker
+        // needs to be done with it first.
+        for (std::thread& iterative_worker : workers)
+            iterative_worker.join();
+    };
+}
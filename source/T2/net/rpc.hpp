@@ -0,0 +1,111 @@
+#ifndef T2_NET_RPC
+#define T2_NET_RPC
+
+#include <map>
+#include <chrono>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/endian/arithmetic.hpp>
+
+#include "./net.hpp"
+#include "../utility/utility.hpp"
+
+namespace T2 {
+    namespace net {
+        // Every RPC message (in either direction) is prefixed with one of these headers, the
+        // correlation ID of a response matches that of the request that it is answering.
+        struct rpc_frame_header {
+            enum frame_kinds : uint16_t {
+                request,
+                response,
+                error_response // Payload is a (non-terminated) error string.
+            };
+            boost::endian::big_uint32_t correlation_id;
+            boost::endian::big_uint32_t payload_size;
+            boost::endian::big_uint16_t kind;
+        };
+
+        // Helpers shared by the rpc_client and rpc_server. These bypass T2::net::client's
+        // asio_loop and use blocking reads/writes on the client's socket directly, reads are
+        // sized to the frame so a large payload costs a handful of syscalls rather than
+        // one trip through the asio_loop (and T2::utility::blocking_timer) per chunk.
+        class rpc_frame {
+        public:
+            // Frames that claim to be larger than this are treated as a protocol error rather
+            // than being allocated, otherwise a peer could exhaust our memory with one header.
+            static constexpr size_t max_payload_size = 16 * 1024 * 1024;
+
+            // Writes the header and payload in full, the caller is responsible for serialising
+            // calls that share a client.
+            static void send(T2::net::client& connection, const uint32_t correlation_id,
+                const rpc_frame_header::frame_kinds kind, const boost::asio::const_buffer& payload);
+
+            // Blocks until one whole frame has been read into 'header' and 'payload'. Throws if
+            // the peer has disconnected, sent a malformed header, or ...::interrupt() was called.
+            static void receive(T2::net::client& connection, rpc_frame_header& header,
+                std::vector<uint8_t>& payload);
+
+            // Wakes a thread that is blocked in ...::receive() by shutting down the receiving
+            // half of the connection, nothing further can be received on it afterwards.
+            static void interrupt(T2::net::client& connection);
+        };
+
+        // Allows any amount of requests to be in-flight over one T2::net::client at once, responses
+        // are matched to their callers by correlation ID so they may arrive in any order.
+        class rpc_client {
+        private:
+            struct pending_call {
+                std::promise<std::vector<uint8_t>> response;
+                std::chrono::steady_clock::time_point deadline;
+            };
+
+            T2::net::client& connection;
+            std::mutex send_mutex;
+            T2::utility::mutex_wrapped<std::map<uint32_t, pending_call>> pending_calls;
+            std::condition_variable pending_calls_changed; // Wakes timeout_loop, uses pending_calls.mutex.
+            std::atomic<uint32_t> next_correlation_id = 0;
+            std::atomic<bool> actively_receiving = true;
+            std::thread receive_thread;
+            std::thread timeout_thread;
+
+            void receive_loop();
+            void timeout_loop();
+            // Must be called with pending_calls.mutex held.
+            void fail_pending_calls(const std::string& reason);
+        public:
+            // The client must already be connected and must outlive this object, it shouldn't
+            // be used for anything else whilst this object exists. Destroying this object shuts
+            // down the receiving half of the connection.
+            rpc_client(T2::net::client& connection);
+            ~rpc_client();
+
+            // The returned future either holds the response payload or throws a std::runtime_error
+            // if the request timed out, the peer's handler failed, or the connection was lost.
+            [[nodiscard]] std::future<std::vector<uint8_t>> call_async(const boost::asio::const_buffer& request,
+                const std::chrono::milliseconds& timeout = std::chrono::milliseconds(2500));
+            // Blocking wrapper around ...::call_async().
+            [[nodiscard]] std::vector<uint8_t> call(const boost::asio::const_buffer& request,
+                const std::chrono::milliseconds& timeout = std::chrono::milliseconds(2500));
+        };
+
+        class rpc_server {
+        public:
+            typedef std::function<std::vector<uint8_t>(const boost::asio::const_buffer&)> request_handler;
+
+            // Produces a connection handler for T2::net::server::start_listening() that reads
+            // frames until the peer disconnects, running 'handler' on a pool of 'worker_count'
+            // threads and replying as soon as it returns (so responses may be out of order).
+            // Reading pauses whilst 'worker_count' requests are queued behind busy workers.
+            // An exception thrown by 'handler' is returned to the caller as an error_response.
+            static std::function<void(T2::net::client* const)> dispatcher(const request_handler& handler,
+                const size_t worker_count = 8);
+        };
+    };
+};
+
+#endif
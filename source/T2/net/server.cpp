@@ -10,21 +10,21 @@
 T2::net::server::server(const uint16_t port) : port(port) { }
 
 void T2::net::server::call_handlers(const std::vector<std::function<void(T2::net::client* const)>>& handlers,
-    T2::net::client* const accepted_client) {
+    T2::net::client* const accepted_client, const bool catch_listeners) {
 
-    for (const std::function<void(T2::net::client* const)>& iterative_handler : connection_handlers) {
+    for (const std::function<void(T2::net::client* const)>& iterative_handler : handlers) {
         try {
             iterative_handler(accepted_client);
         } catch (std::runtime_error& exception_object) {
 #if defined(_DEBUG)
-        std::clog << "T2::net::server::listen_loop() @ " + std::to_string(__LINE__) + ": "
+        std::clog << "T2::net::server::call_handlers() @ " + std::to_string(__LINE__) + ": "
             "Iterative handler threw an exception when processing connection - " +
             std::string(exception_object.what()) + ".\r\n";
 #endif
-            if (!catch_listeners) {
-                delete accepted_client; // Disconnects and frees resources.
-                std::__throw_runtime_error("Server listener threw an exception.");
-            }
+            // This runs on its own (detached) thread so there's nobody to rethrow to, doing so
+            // would just terminate the process. Skip the remaining handlers instead.
+            if (!catch_listeners)
+                break;
         }
     }
     // In this capacity, delete will call the destructor for T2::net::client which will,
@@ -48,7 +48,16 @@ void T2::net::server::listen_loop(
         boost::asio::ip::tcp::socket active_socket(T2::net::client::asio_context);
         boost::system::error_code accept_result;
         server_acceptor.accept(active_socket, accept_result);
-        if (accept_result.value() == 35) { // The request would've blocked.
+        if (accept_result == boost::asio::error::would_block || accept_result == boost::asio::error::try_again) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(150));
+            continue;
+        }
+        else if (accept_result) {
+#if defined(_DEBUG)
+            std::cerr << "T2::net::server::listen_loop() @ " + std::to_string(__LINE__) + ": "
+                "accept() failed - " + accept_result.message() + ".\r\n";
+#endif
+            // Errors like EMFILE tend to persist, retrying straight away would spin.
             std::this_thread::sleep_for(std::chrono::milliseconds(150));
             continue;
         }
@@ -60,9 +69,21 @@ void T2::net::server::listen_loop(
 #endif
 
         // T2::net::server::call_handlers will delete the T2::net::client object when finished.
-        T2::net::client* const accepted_client = new T2::net::client(active_socket);
-        // TODO: Bind the call_handlers function to connection_handlers at the start.
-        std::async(std::launch::async, T2::net::server::call_handlers, connection_handlers, accepted_client);
+        T2::net::client* accepted_client = nullptr;
+        try {
+            accepted_client = new T2::net::client(active_socket);
+        } catch (std::runtime_error& exception_object) {
+            // Most likely the peer reset the connection before we could query its endpoint.
+#if defined(_DEBUG)
+            std::cerr << "T2::net::server::listen_loop() @ " + std::to_string(__LINE__) + ": "
+                "Failed to wrap accepted connection - " + std::string(exception_object.what()) + ".\r\n";
+#endif
+            continue;
+        }
+        // Handlers can be long-lived (e.g. T2::net::rpc_server::dispatcher) so each connection
+        // gets its own thread rather than holding up the accept loop. The handlers are copied
+        // in as connection_handlers only lives as long as this loop.
+        std::thread(T2::net::server::call_handlers, connection_handlers, accepted_client, catch_listeners).detach();
     }
     this->cleaned_up = true;
 }